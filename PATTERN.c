@@ -0,0 +1,249 @@
+#include "PATTERN.h"
+
+typedef struct
+{
+    const Pattern_TableType *table;         /* Table currently running on the channel */
+    const Pattern_TableType *nextTable;     /* Table queued to replace the running one at the end of its period */
+    uint32 tick;                            /* Ticks elapsed since the start of the running table */
+    uint16 index;                           /* Index of the next entry to be applied */
+    Pattern_PortType port;
+    boolean active;
+}Pattern_ChannelStateType;
+
+/* Global array to hold the state of every pattern channel, shared with the SysTick interrupt */
+static volatile Pattern_ChannelStateType g_PatternChannels[PATTERN_MAX_CHANNELS];
+
+/* Base address of every GPIO port indexed by Pattern_PortType */
+static const uint32 g_PatternPortBase[PATTERN_NUM_OF_PORTS] =
+{
+    PATTERN_GPIO_PORTA_BASE,
+    PATTERN_GPIO_PORTB_BASE,
+    PATTERN_GPIO_PORTC_BASE,
+    PATTERN_GPIO_PORTD_BASE,
+    PATTERN_GPIO_PORTE_BASE,
+    PATTERN_GPIO_PORTF_BASE
+};
+
+
+/*********************************************************************
+ * Service Name: Pattern_IsTableValid
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): Table - Pointer to the schedule table
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: boolean - TRUE if the table can be run by the engine
+ * Description: Check that the entries are sorted by tickOffset and, for a looping table, that every tickOffset < period.
+**********************************************************************/
+static boolean Pattern_IsTableValid(const Pattern_TableType *Table){
+    uint16 index;
+
+    if((Table == NULL_PTR) || ((Table->entries == NULL_PTR) && (Table->length != 0))){
+        return FALSE;
+    }
+
+    for(index = 0; index < Table->length; index++){
+        if((index > 0) && (Table->entries[index].tickOffset < Table->entries[index - 1].tickOffset)){
+            return FALSE;    /* Unsorted entries would stall the channel */
+        }
+        if((Table->period != 0) && (Table->entries[index].tickOffset >= Table->period)){
+            return FALSE;    /* Entry would never be reached before the table loops */
+        }
+    }
+
+    return TRUE;
+}
+
+
+/*********************************************************************
+ * Service Name: Pattern_Init
+ * Sync/Async: Synchronous
+ * Reentrancy: Non reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Initialize the pattern engine and stop all the channels.
+**********************************************************************/
+void Pattern_Init(void){
+    Pattern_ChannelType channel;
+
+    for(channel = 0; channel < PATTERN_MAX_CHANNELS; channel++){
+        g_PatternChannels[channel].active    = FALSE;
+        g_PatternChannels[channel].table     = NULL_PTR;
+        g_PatternChannels[channel].nextTable = NULL_PTR;
+        g_PatternChannels[channel].tick      = 0;
+        g_PatternChannels[channel].index     = 0;
+        g_PatternChannels[channel].port      = PATTERN_PORTA;
+    }
+}
+
+
+/*********************************************************************
+ * Service Name: Pattern_Start
+ * Sync/Async: Synchronous
+ * Reentrancy: Non reentrant
+ * Parameters (in): Channel - Pattern channel number
+ *                  Port - GPIO port driven by the pattern
+ *                  Table - Pointer to the schedule table
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Start running the schedule table on the given channel from its first entry.
+**********************************************************************/
+void Pattern_Start(Pattern_ChannelType Channel, Pattern_PortType Port, const Pattern_TableType *Table){
+    if((Channel >= PATTERN_MAX_CHANNELS) || (Port > PATTERN_PORTF) || (Pattern_IsTableValid(Table) == FALSE)){
+        return;
+    }
+
+    /* Deactivate the channel first so the SysTick interrupt never sees a half updated state */
+    g_PatternChannels[Channel].active    = FALSE;
+    g_PatternChannels[Channel].table     = Table;
+    g_PatternChannels[Channel].nextTable = NULL_PTR;
+    g_PatternChannels[Channel].tick      = 0;
+    g_PatternChannels[Channel].index     = 0;
+    g_PatternChannels[Channel].port      = Port;
+    g_PatternChannels[Channel].active    = TRUE;
+}
+
+
+/*********************************************************************
+ * Service Name: Pattern_SwapTable
+ * Sync/Async: Synchronous
+ * Reentrancy: Non reentrant
+ * Parameters (in): Channel - Pattern channel number
+ *                  Table - Pointer to the new schedule table
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Queue a new schedule table for a channel already started with Pattern_Start. It replaces the running
+ *              table at the end of its period, or after its last entry for a one-shot table. If the channel is
+ *              stopped the new table starts immediately.
+**********************************************************************/
+void Pattern_SwapTable(Pattern_ChannelType Channel, const Pattern_TableType *Table){
+    if((Channel >= PATTERN_MAX_CHANNELS) || (g_PatternChannels[Channel].table == NULL_PTR) || (Pattern_IsTableValid(Table) == FALSE)){
+        return;
+    }
+
+    /* Queue the table first, a running channel picks it up in the SysTick interrupt */
+    g_PatternChannels[Channel].nextTable = Table;
+
+    /* A stopped channel is never touched by the SysTick interrupt, so start the queued table here */
+    if(g_PatternChannels[Channel].active == FALSE){
+        g_PatternChannels[Channel].table     = Table;
+        g_PatternChannels[Channel].nextTable = NULL_PTR;
+        g_PatternChannels[Channel].tick      = 0;
+        g_PatternChannels[Channel].index     = 0;
+        g_PatternChannels[Channel].active    = TRUE;
+    }
+}
+
+
+/*********************************************************************
+ * Service Name: Pattern_IsSwapPending
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): Channel - Pattern channel number
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: boolean - TRUE while the table queued by Pattern_SwapTable is not running yet
+ * Description: Function to check if a swap is pending, once it returns FALSE the previous table is free to be refilled.
+**********************************************************************/
+boolean Pattern_IsSwapPending(Pattern_ChannelType Channel){
+    if(Channel >= PATTERN_MAX_CHANNELS){
+        return FALSE;
+    }
+
+    return (g_PatternChannels[Channel].nextTable != NULL_PTR) ? TRUE : FALSE;
+}
+
+
+/*********************************************************************
+ * Service Name: Pattern_Stop
+ * Sync/Async: Synchronous
+ * Reentrancy: Non reentrant
+ * Parameters (in): Channel - Pattern channel number
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Stop the pattern running on the channel, the pins keep their last value. A table queued by
+ *              Pattern_SwapTable is dropped, so Pattern_IsSwapPending returns FALSE after the stop.
+**********************************************************************/
+void Pattern_Stop(Pattern_ChannelType Channel){
+    if(Channel >= PATTERN_MAX_CHANNELS){
+        return;
+    }
+
+    g_PatternChannels[Channel].active    = FALSE;
+    g_PatternChannels[Channel].nextTable = NULL_PTR;    /* A stopped channel is never swapped by the SysTick interrupt */
+}
+
+
+/*********************************************************************
+ * Service Name: Pattern_Tick
+ * Sync/Async: Asynchronous
+ * Reentrancy: Non reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Apply all the due entries with one masked DATA write per port, to be set as the SysTick call-back.
+**********************************************************************/
+void Pattern_Tick(void){
+    uint8 portMask[PATTERN_NUM_OF_PORTS]  = {0};
+    uint8 portValue[PATTERN_NUM_OF_PORTS] = {0};
+    Pattern_ChannelType channel;
+    uint8 port;
+
+    for(channel = 0; channel < PATTERN_MAX_CHANNELS; channel++){
+        volatile Pattern_ChannelStateType *state = &g_PatternChannels[channel];
+        const Pattern_TableType *table;
+        const Pattern_EntryType *entry;
+
+        if(state->active == FALSE){
+            continue;
+        }
+
+        table = state->table;
+        port  = state->port;
+
+        /* Merge every due entry of this channel into the pending write of its port, later entries win */
+        while((state->index < table->length) && (table->entries[state->index].tickOffset <= state->tick)){
+            entry = &table->entries[state->index];
+            portMask[port] |= entry->mask;
+            portValue[port] = (portValue[port] & ~entry->mask) | (entry->value & entry->mask);
+            state->index++;
+        }
+
+        state->tick++;
+
+        if(table->period == 0){
+            if(state->index >= table->length){
+                if(state->nextTable != NULL_PTR){
+                    state->table     = state->nextTable;    /* One-shot table finished, continue with the queued one */
+                    state->nextTable = NULL_PTR;
+                    state->tick      = 0;
+                    state->index     = 0;
+                }
+                else{
+                    state->active = FALSE;                  /* One-shot table finished */
+                }
+            }
+        }
+        else if(state->tick >= table->period){
+            state->tick  = 0;                               /* Loop back to the first entry */
+            state->index = 0;
+            if(state->nextTable != NULL_PTR){
+                state->table     = state->nextTable;        /* Swap the buffers at the period boundary */
+                state->nextTable = NULL_PTR;
+            }
+        }
+    }
+
+    /* One masked DATA store per port, only the bits in the mask are changed by the hardware */
+    for(port = 0; port < PATTERN_NUM_OF_PORTS; port++){
+        if(portMask[port] != 0){
+            *(volatile uint32 *)(g_PatternPortBase[port] + ((uint32)portMask[port] << 2)) = portValue[port];
+        }
+    }
+}
@@ -0,0 +1,136 @@
+#ifndef PATTERN_H_
+#define PATTERN_H_
+
+#include "tm4c123gh6pm_registers.h"
+#include "std_types.h"
+
+/* Maximum number of patterns that can run at the same time */
+#define PATTERN_MAX_CHANNELS        4
+
+/* Number of GPIO ports handled by the engine (PORTA .. PORTF) */
+#define PATTERN_NUM_OF_PORTS        6
+
+/* APB base addresses of the GPIO ports, the masked DATA register of a port is at (base + (mask << 2)) */
+#define PATTERN_GPIO_PORTA_BASE     0x40004000
+#define PATTERN_GPIO_PORTB_BASE     0x40005000
+#define PATTERN_GPIO_PORTC_BASE     0x40006000
+#define PATTERN_GPIO_PORTD_BASE     0x40007000
+#define PATTERN_GPIO_PORTE_BASE     0x40024000
+#define PATTERN_GPIO_PORTF_BASE     0x40025000
+
+typedef enum
+{
+    PATTERN_PORTA,
+    PATTERN_PORTB,
+    PATTERN_PORTC,
+    PATTERN_PORTD,
+    PATTERN_PORTE,
+    PATTERN_PORTF
+}Pattern_PortType;
+
+typedef uint8 Pattern_ChannelType;
+
+/* One step of a pattern: at tickOffset ticks from the start of the table drive the pins in mask to value */
+typedef struct
+{
+    uint32 tickOffset;
+    uint8  mask;
+    uint8  value;
+}Pattern_EntryType;
+
+/* Precomputed schedule table, entries must be sorted by tickOffset.
+ * period = 0 means the pattern runs once, otherwise it restarts every period ticks and every tickOffset must be < period.
+ * Tables breaking these rules are rejected by Pattern_Start and Pattern_SwapTable.
+ */
+typedef struct
+{
+    const Pattern_EntryType *entries;
+    uint16 length;
+    uint32 period;
+}Pattern_TableType;
+
+
+/*********************************************************************
+ * Service Name: Pattern_Init
+ * Sync/Async: Synchronous
+ * Reentrancy: Non reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Initialize the pattern engine and stop all the channels.
+**********************************************************************/
+void Pattern_Init(void);
+
+
+/*********************************************************************
+ * Service Name: Pattern_Start
+ * Sync/Async: Synchronous
+ * Reentrancy: Non reentrant
+ * Parameters (in): Channel - Pattern channel number
+ *                  Port - GPIO port driven by the pattern
+ *                  Table - Pointer to the schedule table
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Start running the schedule table on the given channel from its first entry.
+**********************************************************************/
+void Pattern_Start(Pattern_ChannelType Channel, Pattern_PortType Port, const Pattern_TableType *Table);
+
+
+/*********************************************************************
+ * Service Name: Pattern_SwapTable
+ * Sync/Async: Synchronous
+ * Reentrancy: Non reentrant
+ * Parameters (in): Channel - Pattern channel number
+ *                  Table - Pointer to the new schedule table
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Queue a new schedule table for a channel already started with Pattern_Start. It replaces the running
+ *              table at the end of its period, or after its last entry for a one-shot table. If the channel is
+ *              stopped the new table starts immediately.
+**********************************************************************/
+void Pattern_SwapTable(Pattern_ChannelType Channel, const Pattern_TableType *Table);
+
+
+/*********************************************************************
+ * Service Name: Pattern_IsSwapPending
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): Channel - Pattern channel number
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: boolean - TRUE while the table queued by Pattern_SwapTable is not running yet
+ * Description: Function to check if a swap is pending, once it returns FALSE the previous table is free to be refilled.
+**********************************************************************/
+boolean Pattern_IsSwapPending(Pattern_ChannelType Channel);
+
+
+/*********************************************************************
+ * Service Name: Pattern_Stop
+ * Sync/Async: Synchronous
+ * Reentrancy: Non reentrant
+ * Parameters (in): Channel - Pattern channel number
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Stop the pattern running on the channel, the pins keep their last value. A table queued by
+ *              Pattern_SwapTable is dropped, so Pattern_IsSwapPending returns FALSE after the stop.
+**********************************************************************/
+void Pattern_Stop(Pattern_ChannelType Channel);
+
+
+/*********************************************************************
+ * Service Name: Pattern_Tick
+ * Sync/Async: Asynchronous
+ * Reentrancy: Non reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Apply all the due entries with one masked DATA write per port, to be set as the SysTick call-back.
+**********************************************************************/
+void Pattern_Tick(void);
+
+#endif /* PATTERN_H_ */
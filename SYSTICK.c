@@ -1,7 +1,15 @@
 #include "SYSTICK.h"
+#include "TRACE_CFG.h"
+
+#if TRACE_ENABLE
+#include "TRACE.h"
+#endif
 
 /* Global variable to hold the address of the call back function */
-static volatile void (*g_SysTickcallBackPtr)(void) = NULL_PTR;
+static void (*volatile g_SysTickcallBackPtr)(void) = NULL_PTR;
+
+/* Global variable to count the SysTick interrupts, used with the Current Register to build timestamps */
+static volatile uint32 g_SysTickOverflowCount = 0;
 
 
 /*********************************************************************
@@ -19,6 +27,7 @@ void SysTick_Init(uint16 a_TimeInMilliSeconds){
     uint32 reloadValue  = ((MCU_Freq_Hz/1000)*a_TimeInMilliSeconds) - 1;
     SYSTICK_RELOAD_REG  = reloadValue;                                     /* Set the Reload value with time needed */
     SYSTICK_CURRENT_REG = 0;                                               /* Clear the Current Register value */
+    g_SysTickOverflowCount = 0;                                            /* Restart counting the SysTick interrupts */
 
     /* Configure the SysTick Control Register
      * Enable the SysTick Timer (ENABLE = 1)
@@ -26,6 +35,10 @@ void SysTick_Init(uint16 a_TimeInMilliSeconds){
      * Choose the clock source to be System Clock (CLK_SRC = 1)
      */
     SYSTICK_CTRL_REG   |= 0x07;
+
+#if TRACE_ENABLE
+    Trace_SysTickInitHook();                                               /* The overflow count restarted, tell the trace */
+#endif
 }
 
 
@@ -68,9 +81,19 @@ void SysTick_StartBusyWait(uint16 a_TimeInMilliSeconds){
  * Description: Handler for SysTick interrupt used to call the call-back function.
 **********************************************************************/
 void SysTick_Handler(void){
+    g_SysTickOverflowCount++;
+
+#if TRACE_ENABLE
+    Trace_ExceptionEnter(TRACE_SYSTICK_EXCEPTION_NUM);
+#endif
+
     if(g_SysTickcallBackPtr != NULL_PTR){
         (*g_SysTickcallBackPtr)();
     }
+
+#if TRACE_ENABLE
+    Trace_ExceptionExit(TRACE_SYSTICK_EXCEPTION_NUM);
+#endif
 }
 
 
@@ -84,7 +107,7 @@ void SysTick_Handler(void){
  * Return value: None
  * Description: Function to setup the SysTick Timer call back to be executed in SysTick Handler.
 **********************************************************************/
-void SysTick_SetCallBack(volatile void (*Ptr2Func) (void)){
+void SysTick_SetCallBack(void (*Ptr2Func) (void)){
     g_SysTickcallBackPtr = Ptr2Func;
 }
 
@@ -134,3 +157,18 @@ void SysTick_DeInit(void){
     SYSTICK_RELOAD_REG  = 0;             /* Clear Reload Register value */
     SYSTICK_CURRENT_REG = 0;             /* Clear the Current Register value */
 }
+
+
+/*********************************************************************
+ * Service Name: SysTick_GetOverflowCount
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: uint32 - Number of SysTick interrupts since SysTick_Init
+ * Description: Function to get the number of times the SysTick Timer reached ZERO in interrupt mode.
+**********************************************************************/
+uint32 SysTick_GetOverflowCount(void){
+    return g_SysTickOverflowCount;
+}
@@ -56,7 +56,7 @@ void SysTick_Handler(void);
  * Return value: None
  * Description: Function to setup the SysTick Timer call back to be executed in SysTick Handler.
 **********************************************************************/
-void SysTick_SetCallBack(volatile void (*Ptr2Func) (void));
+void SysTick_SetCallBack(void (*Ptr2Func) (void));
 
 
 /*********************************************************************
@@ -97,4 +97,17 @@ void SysTick_Start(void);
 **********************************************************************/
 void SysTick_DeInit(void);
 
+
+/*********************************************************************
+ * Service Name: SysTick_GetOverflowCount
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: uint32 - Number of SysTick interrupts since SysTick_Init
+ * Description: Function to get the number of times the SysTick Timer reached ZERO in interrupt mode.
+**********************************************************************/
+uint32 SysTick_GetOverflowCount(void);
+
 #endif /* SYSTICK_H_ */
@@ -0,0 +1,256 @@
+#include "TRACE.h"
+#include "SYSTICK.h"
+#include <stddef.h>
+
+/* Reserve the next slot index without locking out other writers, a LDREX/STREX retry loop on Cortex-M4.
+ * A writer preempted between the exclusive load and store loses its reservation and retries.
+ */
+#if defined(__TI_COMPILER_VERSION__)
+#define TRACE_RESERVE_SLOT(Index)   do{                                                                 \
+                                        (Index) = (uint32)__ldrex((void *)&g_Trace.head);               \
+                                    }while(__strex((Index) + 1, (void *)&g_Trace.head) != 0)
+#elif defined(__GNUC__)
+#define TRACE_RESERVE_SLOT(Index)   ((Index) = __atomic_fetch_add(&g_Trace.head, 1, __ATOMIC_RELAXED))
+#else
+#error "TRACE_RESERVE_SLOT is not implemented for this compiler"
+#endif
+
+/* Compile time checks of the layout hard coded in tools/trace_decode.c */
+typedef char Trace_RecordSizeCheck[(sizeof(Trace_RecordType) == TRACE_RECORD_SIZE) ? 1 : -1];
+typedef char Trace_HeaderSizeCheck[(offsetof(Trace_ControlType, records) == TRACE_HEADER_SIZE) ? 1 : -1];
+
+/* Global trace area, kept in RAM so it can be dumped by the debugger after a fault */
+Trace_ControlType g_Trace;
+
+
+/*********************************************************************
+ * Service Name: Trace_GetTimestamp
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): Overflow - SysTick interrupts count
+ *                   Cycles - Clock cycles elapsed since the last SysTick reload
+ * Return value: None
+ * Description: Read a consistent (overflow, cycles) pair, retried if the SysTick interrupt runs in between.
+ *              A reload not yet counted because the SysTick interrupt is pending is added here. It is only
+ *              detected while the interrupt has been pending for less than half a SysTick period: a record
+ *              written later than that from a higher priority handler (or a fault handler with SysTick masked)
+ *              is one period early, and records cannot tell a missed second reload either.
+**********************************************************************/
+static void Trace_GetTimestamp(uint32 *Overflow, uint32 *Cycles){
+    uint32 overflow;
+    uint32 current;
+    uint32 pending;
+    uint32 reload;
+
+    do{
+        overflow = SysTick_GetOverflowCount();
+        current  = SYSTICK_CURRENT_REG;
+        pending  = TRACE_NVIC_INT_CTRL_REG & TRACE_PENDSTSET_MASK;    /* Read after CURRENT so a reload in between leaves CURRENT near ZERO */
+    }while(overflow != SysTick_GetOverflowCount());
+
+    reload = SYSTICK_RELOAD_REG;
+
+    /* Called above the SysTick priority after the counter reloaded: CURRENT restarted near RELOAD but the count is behind */
+    if((pending != 0) && (current > (reload >> 1))){
+        overflow++;
+    }
+
+    *Overflow = overflow;
+    *Cycles   = reload - current;
+}
+
+
+/*********************************************************************
+ * Service Name: Trace_Init
+ * Sync/Async: Synchronous
+ * Reentrancy: Non reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Clear the trace ring and put the trace in stopped state, also releases a frozen trace.
+**********************************************************************/
+void Trace_Init(void){
+    uint32 index;
+
+    g_Trace.state = TRACE_STATE_STOPPED;
+    g_Trace.magic = TRACE_MAGIC;
+    g_Trace.size   = TRACE_BUFFER_SIZE;
+    g_Trace.reload = 0;
+    g_Trace.head   = 0;
+
+    for(index = 0; index < TRACE_BUFFER_SIZE; index++){
+        g_Trace.records[index].type = TRACE_EVENT_NONE;
+    }
+}
+
+
+/*********************************************************************
+ * Service Name: Trace_Start
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Start recording events, has no effect if the trace is frozen. To be called after SysTick_Init.
+**********************************************************************/
+void Trace_Start(void){
+    if(g_Trace.state == TRACE_STATE_STOPPED){
+        g_Trace.reload = SYSTICK_RELOAD_REG;    /* Kept in the header, the START record may be overwritten by the ring */
+        g_Trace.state  = TRACE_STATE_RUNNING;
+        Trace_Record(TRACE_EVENT_START, TRACE_START_BY_USER, g_Trace.reload);
+    }
+}
+
+
+/*********************************************************************
+ * Service Name: Trace_Stop
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Stop recording events, the recorded events are kept.
+**********************************************************************/
+void Trace_Stop(void){
+    if(g_Trace.state == TRACE_STATE_RUNNING){
+        Trace_Record(TRACE_EVENT_STOP, 0, 0);
+        g_Trace.state = TRACE_STATE_STOPPED;
+    }
+}
+
+
+/*********************************************************************
+ * Service Name: Trace_Record
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): Event - Type of the event
+ *                  Number - Exception number or user event id
+ *                  Arg - Event argument
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Add a timestamped record to the trace ring, safe to be called from any interrupt level.
+**********************************************************************/
+void Trace_Record(Trace_EventType Event, uint8 Number, uint32 Arg){
+    volatile Trace_RecordType *record;
+    uint32 index;
+    uint32 overflow;
+    uint32 cycles;
+
+    if(g_Trace.state != TRACE_STATE_RUNNING){
+        return;
+    }
+
+    /* Reserve a slot, a preempting writer gets its own slot */
+    TRACE_RESERVE_SLOT(index);
+    record = &g_Trace.records[index & (TRACE_BUFFER_SIZE - 1)];
+    record->type = TRACE_EVENT_NONE;        /* Invalidate the old record before anything else, the buffer may be dumped at any time */
+
+    Trace_GetTimestamp(&overflow, &cycles);
+
+    record->overflow = overflow;
+    record->cycles   = cycles;
+    record->number   = Number;
+    record->reserved = 0;
+    record->arg      = Arg;
+    record->type     = Event;               /* Written last to mark the record as complete */
+}
+
+
+/*********************************************************************
+ * Service Name: Trace_ExceptionEnter
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): Exception_Num - Exception number from the vector table
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Hook to be called at the start of an exception handler.
+**********************************************************************/
+void Trace_ExceptionEnter(uint8 Exception_Num){
+    Trace_Record(TRACE_EVENT_ENTER, Exception_Num, 0);
+}
+
+
+/*********************************************************************
+ * Service Name: Trace_ExceptionExit
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): Exception_Num - Exception number from the vector table
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Hook to be called at the end of an exception handler.
+**********************************************************************/
+void Trace_ExceptionExit(uint8 Exception_Num){
+    Trace_Record(TRACE_EVENT_EXIT, Exception_Num, 0);
+}
+
+
+/*********************************************************************
+ * Service Name: Trace_IrqEnter
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): IRQ_Num - Number of the IRQ from the target vector table
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Hook to be called at the start of an IRQ handler.
+**********************************************************************/
+void Trace_IrqEnter(NVIC_IRQType IRQ_Num){
+    Trace_Record(TRACE_EVENT_ENTER, IRQ_Num + TRACE_IRQ_EXCEPTION_NUM_BASE, 0);
+}
+
+
+/*********************************************************************
+ * Service Name: Trace_IrqExit
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): IRQ_Num - Number of the IRQ from the target vector table
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Hook to be called at the end of an IRQ handler.
+**********************************************************************/
+void Trace_IrqExit(NVIC_IRQType IRQ_Num){
+    Trace_Record(TRACE_EVENT_EXIT, IRQ_Num + TRACE_IRQ_EXCEPTION_NUM_BASE, 0);
+}
+
+
+/*********************************************************************
+ * Service Name: Trace_FaultHook
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): Exception_Num - Exception number of the fault
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Hook to be called from the fault handlers, records the fault then freezes the trace.
+**********************************************************************/
+void Trace_FaultHook(uint8 Exception_Num){
+    Trace_Record(TRACE_EVENT_FAULT, Exception_Num, 0);
+    g_Trace.state = TRACE_STATE_FROZEN;    /* Only Trace_Init can release a frozen trace */
+}
+
+
+/*********************************************************************
+ * Service Name: Trace_SysTickInitHook
+ * Sync/Async: Synchronous
+ * Reentrancy: Non reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Hook called by SysTick_Init, records the new time base so the decoder can join it to the previous one.
+**********************************************************************/
+void Trace_SysTickInitHook(void){
+    if(g_Trace.state == TRACE_STATE_RUNNING){
+        g_Trace.reload = SYSTICK_RELOAD_REG;
+        Trace_Record(TRACE_EVENT_START, TRACE_START_BY_SYSTICK_INIT, g_Trace.reload);
+    }
+}
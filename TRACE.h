@@ -0,0 +1,207 @@
+#ifndef TRACE_H_
+#define TRACE_H_
+
+#include "tm4c123gh6pm_registers.h"
+#include "std_types.h"
+#include "NVIC.h"
+#include "TRACE_CFG.h"
+
+/* Value of Trace_ControlType.magic, used by the host decoder to validate a dumped buffer */
+#define TRACE_MAGIC                     0x54524143
+
+/* Layout shared with tools/trace_decode.c, checked at compile time in TRACE.c */
+#define TRACE_HEADER_SIZE               20
+#define TRACE_RECORD_SIZE               16
+
+/* Interrupt Control and State Register, PENDSTSET is set while the SysTick interrupt is pending */
+#define TRACE_NVIC_INT_CTRL_REG         (*((volatile uint32 *)0xE000ED04))
+#define TRACE_PENDSTSET_MASK            0x04000000
+
+/* Exception numbers as seen in the vector table, external IRQ n is exception (n + 16) */
+#define TRACE_HARD_FAULT_EXCEPTION_NUM  3
+#define TRACE_SYSTICK_EXCEPTION_NUM     15
+#define TRACE_IRQ_EXCEPTION_NUM_BASE    16
+
+/* Number field of a TRACE_EVENT_START record */
+#define TRACE_START_BY_USER             0    /* Trace_Start */
+#define TRACE_START_BY_SYSTICK_INIT     1    /* SysTick re-initialized while tracing, the time base restarts */
+
+#if (TRACE_BUFFER_SIZE & (TRACE_BUFFER_SIZE - 1)) != 0
+#error "TRACE_BUFFER_SIZE must be a power of two"
+#endif
+
+typedef enum
+{
+    TRACE_EVENT_NONE,               /* Empty slot or slot being written */
+    TRACE_EVENT_ENTER,              /* Exception or IRQ handler entry */
+    TRACE_EVENT_EXIT,               /* Exception or IRQ handler exit */
+    TRACE_EVENT_USER,               /* Application event, number and arg are user defined */
+    TRACE_EVENT_START,              /* Trace started or time base restarted, arg = SysTick reload value */
+    TRACE_EVENT_STOP,               /* Trace stopped */
+    TRACE_EVENT_FAULT               /* Fault detected, trace frozen after this record */
+}Trace_EventType;
+
+typedef enum
+{
+    TRACE_STATE_STOPPED,
+    TRACE_STATE_RUNNING,
+    TRACE_STATE_FROZEN
+}Trace_StateType;
+
+/* One 16 bytes trace record, time = overflow * (reload + 1) + cycles */
+typedef struct
+{
+    uint32 overflow;                /* SysTick interrupts count */
+    uint32 cycles;                  /* Clock cycles elapsed since the last SysTick reload */
+    uint8  type;                    /* Trace_EventType, written last to mark the record as complete */
+    uint8  number;                  /* Exception number or user event id */
+    uint16 reserved;
+    uint32 arg;
+}Trace_RecordType;
+
+/* Whole trace area, dump sizeof(Trace_ControlType) bytes from g_Trace to decode it on the host */
+typedef struct
+{
+    uint32 magic;
+    uint32 size;                    /* Number of records in the ring */
+    volatile uint32 reload;         /* SysTick reload value when the trace was started */
+    volatile uint32 head;           /* Free running write index, slot = head & (size - 1) */
+    volatile uint32 state;          /* Trace_StateType */
+    volatile Trace_RecordType records[TRACE_BUFFER_SIZE];
+}Trace_ControlType;
+
+extern Trace_ControlType g_Trace;
+
+
+/*********************************************************************
+ * Service Name: Trace_Init
+ * Sync/Async: Synchronous
+ * Reentrancy: Non reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Clear the trace ring and put the trace in stopped state, also releases a frozen trace.
+**********************************************************************/
+void Trace_Init(void);
+
+
+/*********************************************************************
+ * Service Name: Trace_Start
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Start recording events, has no effect if the trace is frozen. To be called after SysTick_Init.
+**********************************************************************/
+void Trace_Start(void);
+
+
+/*********************************************************************
+ * Service Name: Trace_Stop
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Stop recording events, the recorded events are kept.
+**********************************************************************/
+void Trace_Stop(void);
+
+
+/*********************************************************************
+ * Service Name: Trace_Record
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): Event - Type of the event
+ *                  Number - Exception number or user event id
+ *                  Arg - Event argument
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Add a timestamped record to the trace ring, safe to be called from any interrupt level.
+**********************************************************************/
+void Trace_Record(Trace_EventType Event, uint8 Number, uint32 Arg);
+
+
+/*********************************************************************
+ * Service Name: Trace_ExceptionEnter
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): Exception_Num - Exception number from the vector table
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Hook to be called at the start of an exception handler.
+**********************************************************************/
+void Trace_ExceptionEnter(uint8 Exception_Num);
+
+
+/*********************************************************************
+ * Service Name: Trace_ExceptionExit
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): Exception_Num - Exception number from the vector table
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Hook to be called at the end of an exception handler.
+**********************************************************************/
+void Trace_ExceptionExit(uint8 Exception_Num);
+
+
+/*********************************************************************
+ * Service Name: Trace_IrqEnter
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): IRQ_Num - Number of the IRQ from the target vector table
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Hook to be called at the start of an IRQ handler.
+**********************************************************************/
+void Trace_IrqEnter(NVIC_IRQType IRQ_Num);
+
+
+/*********************************************************************
+ * Service Name: Trace_IrqExit
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): IRQ_Num - Number of the IRQ from the target vector table
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Hook to be called at the end of an IRQ handler.
+**********************************************************************/
+void Trace_IrqExit(NVIC_IRQType IRQ_Num);
+
+
+/*********************************************************************
+ * Service Name: Trace_FaultHook
+ * Sync/Async: Synchronous
+ * Reentrancy: Reentrant
+ * Parameters (in): Exception_Num - Exception number of the fault
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Hook to be called from the fault handlers, records the fault then freezes the trace.
+**********************************************************************/
+void Trace_FaultHook(uint8 Exception_Num);
+
+
+/*********************************************************************
+ * Service Name: Trace_SysTickInitHook
+ * Sync/Async: Synchronous
+ * Reentrancy: Non reentrant
+ * Parameters (in): None
+ * Parameters (inout): None
+ * Parameters (out): None
+ * Return value: None
+ * Description: Hook called by SysTick_Init, records the new time base so the decoder can join it to the previous one.
+**********************************************************************/
+void Trace_SysTickInitHook(void);
+
+#endif /* TRACE_H_ */
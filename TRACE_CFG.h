@@ -0,0 +1,10 @@
+#ifndef TRACE_CFG_H_
+#define TRACE_CFG_H_
+
+/* Set to 0 to remove the trace hooks from the SysTick driver */
+#define TRACE_ENABLE                    1
+
+/* Number of records in the trace ring, must be a power of two */
+#define TRACE_BUFFER_SIZE               256
+
+#endif /* TRACE_CFG_H_ */
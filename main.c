@@ -1,5 +1,7 @@
 #include "SysTick.h"
 #include "NVIC.h"
+#include "PATTERN.h"
+#include "TRACE.h"
 #include "tm4c123gh6pm_registers.h"
 #include <assert.h>
 
@@ -11,6 +13,24 @@
 #define PENDSV_EXCEPTION_PRIORITY           6
 #define SYSTICK_EXCEPTION_PRIORITY          7
 
+#define LEDS_PATTERN_CHANNEL                0
+#define LEDS_MASK                           0x0E
+
+/* RED, Blue then Green LED for 1 second each, SysTick tick = 1 millisecond */
+static const Pattern_EntryType g_LedsSequence[] =
+{
+    {0,    LEDS_MASK, 0x02},   /* Turn on the Red LED and disable the others */
+    {1000, LEDS_MASK, 0x04},   /* Turn on the Blue LED and disable the others */
+    {2000, LEDS_MASK, 0x08}    /* Turn on the Green LED and disable the others */
+};
+
+static const Pattern_TableType g_LedsPattern =
+{
+    g_LedsSequence,
+    sizeof(g_LedsSequence) / sizeof(g_LedsSequence[0]),
+    3000
+};
+
 /* Enable PF1, PF2 and PF3 (RED, Blue and Green LEDs) */
 void Leds_Init(void)
 {
@@ -90,13 +110,18 @@ int main(void)
     /* Test all System and Fault Exceptions settings */
     Test_Exceptions_Settings();
 
+    /* Prepare the interrupts trace, it stays stopped until Trace_Start is called (e.g. from the debugger),
+     * then dump g_Trace and decode it with tools/trace_decode */
+    Trace_Init();
+
+    /* Drive the LEDs sequence from the SysTick interrupt every 1 millisecond */
+    Pattern_Init();
+    Pattern_Start(LEDS_PATTERN_CHANNEL, PATTERN_PORTF, &g_LedsPattern);
+    SysTick_SetCallBack(Pattern_Tick);
+    SysTick_Init(1);
+
     while(1)
     {
-        GPIO_PORTF_DATA_REG = (GPIO_PORTF_DATA_REG & 0xF1) | 0x02; /* Turn on the Red LED and disable the others */
-        SysTick_StartBusyWait(1000); /* Wait 1 second using SysTick Timer */
-        GPIO_PORTF_DATA_REG = (GPIO_PORTF_DATA_REG & 0xF1) | 0x04; /* Turn on the Blue LED and disable the others */
-        SysTick_StartBusyWait(1000); /* Wait 1 second using SysTick Timer */
-        GPIO_PORTF_DATA_REG = (GPIO_PORTF_DATA_REG & 0xF1) | 0x08; /* Turn on the Green LED and disable the others */
-        SysTick_StartBusyWait(1000); /* Wait 1 second using SysTick Timer */
+        __asm(" WFI ");    /* Sleep until the next interrupt, the LEDs are driven by the SysTick interrupt */
     }
 }
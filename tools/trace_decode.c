@@ -0,0 +1,345 @@
+/*
+ * Host side decoder for the TRACE module buffer.
+ *
+ * Dump sizeof(Trace_ControlType) bytes starting at g_Trace from the target
+ * (for example with the debugger memory save command) then run:
+ *
+ *     gcc -O2 -o trace_decode trace_decode.c
+ *     ./trace_decode [-f clock_hz] [-r reload] dump.bin
+ *
+ * The buffer is printed as a timeline followed by per exception statistics
+ * of the handler duration (enter to exit), of the period between entries and,
+ * for SysTick only, of the entry latency. The raw cycles of a SysTick ENTER
+ * record are the time from the counter reload, which pends the interrupt, to
+ * the hook at the start of the handler. External IRQs do not record when
+ * they were pended, so their latency cannot be measured from the trace.
+ *
+ * Every START record carries the SysTick reload of the time base that
+ * follows it. When SysTick was re-initialized the new time base is joined to
+ * the end of the previous one, so the time spent in between is not shown.
+ * -r gives the reload of records older than the first START in the ring.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#define TRACE_MAGIC                 0x54524143
+#define TRACE_HEADER_SIZE           20
+#define TRACE_RECORD_SIZE           16
+#define TRACE_MAX_EXCEPTIONS        256
+#define TRACE_SYSTICK_EXCEPTION_NUM 15
+#define DEFAULT_CLOCK_HZ            16000000
+
+enum
+{
+    TRACE_EVENT_NONE,
+    TRACE_EVENT_ENTER,
+    TRACE_EVENT_EXIT,
+    TRACE_EVENT_USER,
+    TRACE_EVENT_START,
+    TRACE_EVENT_STOP,
+    TRACE_EVENT_FAULT
+};
+
+typedef struct
+{
+    uint64_t time;                  /* Clock cycles since the first time base */
+    uint32_t overflow;              /* Raw SysTick interrupts count */
+    uint32_t cycles;                /* Raw clock cycles since the last SysTick reload */
+    uint32_t sequence;              /* Age in the ring (0 = oldest slot), keeps the write order for equal times */
+    uint32_t arg;
+    uint8_t  type;
+    uint8_t  number;
+}Record;
+
+typedef struct
+{
+    uint32_t count;
+    uint32_t durationCount;
+    uint64_t durationMin;
+    uint64_t durationMax;
+    uint64_t durationSum;
+    uint32_t periodCount;
+    uint64_t periodMin;
+    uint64_t periodMax;
+    uint32_t latencyCount;
+    uint64_t latencyMin;
+    uint64_t latencyMax;
+    uint64_t latencySum;
+    uint64_t lastEnter;
+    int      periodValid;           /* lastEnter belongs to the current time base */
+    int      inside;
+}ExceptionStats;
+
+static uint32_t ReadLe32(const unsigned char *p){
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static const char *ExceptionName(uint8_t number, char *buffer, size_t length){
+    switch(number){
+    case 2:  return "NMI";
+    case 3:  return "HardFault";
+    case 4:  return "MemManage";
+    case 5:  return "BusFault";
+    case 6:  return "UsageFault";
+    case 11: return "SVCall";
+    case 12: return "DebugMon";
+    case 14: return "PendSV";
+    case 15: return "SysTick";
+    default:
+        if(number >= 16){
+            snprintf(buffer, length, "IRQ%u", (unsigned)(number - 16));
+        }
+        else{
+            snprintf(buffer, length, "EXC%u", (unsigned)number);
+        }
+        return buffer;
+    }
+}
+
+static const char *EventName(uint8_t type){
+    switch(type){
+    case TRACE_EVENT_ENTER: return "ENTER";
+    case TRACE_EVENT_EXIT:  return "EXIT";
+    case TRACE_EVENT_USER:  return "USER";
+    case TRACE_EVENT_START: return "START";
+    case TRACE_EVENT_STOP:  return "STOP";
+    case TRACE_EVENT_FAULT: return "FAULT";
+    default:                return "?";
+    }
+}
+
+static int CompareSequence(const void *a, const void *b){
+    const Record *ra = (const Record *)a;
+    const Record *rb = (const Record *)b;
+
+    return (ra->sequence < rb->sequence) ? -1 : (ra->sequence > rb->sequence);
+}
+
+static int CompareRecords(const void *a, const void *b){
+    const Record *ra = (const Record *)a;
+    const Record *rb = (const Record *)b;
+
+    if(ra->time != rb->time){
+        return (ra->time < rb->time) ? -1 : 1;
+    }
+    return (ra->sequence < rb->sequence) ? -1 : (ra->sequence > rb->sequence);
+}
+
+static double ToMicroSeconds(uint64_t cycles, double clockHz){
+    return (double)cycles * 1000000.0 / clockHz;
+}
+
+static void Usage(const char *program){
+    fprintf(stderr, "usage: %s [-f clock_hz] [-r reload] dump.bin\n", program);
+}
+
+int main(int argc, char **argv){
+    double clockHz = DEFAULT_CLOCK_HZ;
+    long reloadOption = -1;
+    const char *path = NULL;
+    unsigned char header[TRACE_HEADER_SIZE];
+    unsigned char raw[TRACE_RECORD_SIZE];
+    uint32_t size, head, state, slot, index, count = 0;
+    uint64_t reload, offset = 0, last = 0;
+    Record *records;
+    ExceptionStats *stats;
+    FILE *file;
+    char name[16];
+    int i;
+
+    for(i = 1; i < argc; i++){
+        if((strcmp(argv[i], "-f") == 0) && (i + 1 < argc)){
+            clockHz = strtod(argv[++i], NULL);
+        }
+        else if((strcmp(argv[i], "-r") == 0) && (i + 1 < argc)){
+            reloadOption = strtol(argv[++i], NULL, 0);
+        }
+        else if((argv[i][0] != '-') && (path == NULL)){
+            path = argv[i];
+        }
+        else{
+            Usage(argv[0]);
+            return 1;
+        }
+    }
+    if((path == NULL) || (clockHz <= 0)){
+        Usage(argv[0]);
+        return 1;
+    }
+
+    file = fopen(path, "rb");
+    if(file == NULL){
+        perror(path);
+        return 1;
+    }
+    if(fread(header, 1, sizeof(header), file) != sizeof(header)){
+        fprintf(stderr, "%s: truncated header\n", path);
+        fclose(file);
+        return 1;
+    }
+    if(ReadLe32(&header[0]) != TRACE_MAGIC){
+        fprintf(stderr, "%s: bad magic 0x%08X, not a trace dump\n", path, (unsigned)ReadLe32(&header[0]));
+        fclose(file);
+        return 1;
+    }
+    size   = ReadLe32(&header[4]);
+    reload = ReadLe32(&header[8]);
+    head   = ReadLe32(&header[12]);
+    state  = ReadLe32(&header[16]);
+    if((size == 0) || ((size & (size - 1)) != 0)){
+        fprintf(stderr, "%s: bad ring size %u\n", path, (unsigned)size);
+        fclose(file);
+        return 1;
+    }
+
+    records = calloc(size, sizeof(Record));
+    stats   = calloc(TRACE_MAX_EXCEPTIONS, sizeof(ExceptionStats));
+    if((records == NULL) || (stats == NULL)){
+        fprintf(stderr, "out of memory\n");
+        fclose(file);
+        return 1;
+    }
+
+    /* Read every completed slot, head is free running and may have wrapped so it only gives the write order */
+    for(slot = 0; slot < size; slot++){
+        if((fseek(file, TRACE_HEADER_SIZE + (long)slot * TRACE_RECORD_SIZE, SEEK_SET) != 0) ||
+           (fread(raw, 1, sizeof(raw), file) != sizeof(raw))){
+            fprintf(stderr, "%s: truncated record %u\n", path, (unsigned)slot);
+            break;
+        }
+        if((raw[8] == TRACE_EVENT_NONE) || (raw[8] > TRACE_EVENT_FAULT)){
+            continue;    /* Slot reserved but not completed when the buffer was dumped */
+        }
+        records[count].overflow = ReadLe32(&raw[0]);
+        records[count].cycles   = ReadLe32(&raw[4]);
+        records[count].sequence = (slot - head) & (size - 1);    /* The slot at head is the next to be overwritten, so the oldest */
+        records[count].arg      = ReadLe32(&raw[12]);
+        records[count].type     = raw[8];
+        records[count].number   = raw[9];
+        count++;
+    }
+    fclose(file);
+
+    /* Walk the ring in write order to find the time base of every record */
+    qsort(records, count, sizeof(Record), CompareSequence);
+
+    for(index = 0; (index < count) && (records[index].type != TRACE_EVENT_START); index++);
+    if(reloadOption >= 0){
+        reload = (uint64_t)reloadOption;
+    }
+    else if((index < count) && (index != 0)){
+        reload = records[index].arg;
+        fprintf(stderr, "oldest records have no START, assuming the reload of the next one (%llu), use -r to override\n",
+                (unsigned long long)reload);
+    }
+    if(reload == 0){
+        reload = (uint64_t)(clockHz / 1000) - 1;
+        fprintf(stderr, "trace never started, assuming a 1 ms SysTick (reload %llu), use -r to override\n", (unsigned long long)reload);
+    }
+
+    for(index = 0; index < count; index++){
+        Record *record = &records[index];
+        uint64_t time;
+
+        if(record->type == TRACE_EVENT_START){
+            reload = record->arg;
+        }
+        time = (uint64_t)record->overflow * (reload + 1) + record->cycles;
+        if((record->type == TRACE_EVENT_START) && (time + offset < last)){
+            offset = last - time;    /* SysTick re-initialized, continue from the end of the previous time base */
+        }
+        record->time = time + offset;
+        if(record->time > last){
+            last = record->time;
+        }
+    }
+    qsort(records, count, sizeof(Record), CompareRecords);
+
+    printf("ring %u records, head %u, reload %llu, state %s, %u events decoded\n\n", (unsigned)size, (unsigned)head,
+           (unsigned long long)reload,
+           (state == 0) ? "STOPPED" : (state == 1) ? "RUNNING" : (state == 2) ? "FROZEN" : "?", (unsigned)count);
+    printf("%14s %12s  %-6s %-12s %s\n", "time(us)", "delta(us)", "event", "source", "arg");
+
+    for(index = 0; index < count; index++){
+        Record *record = &records[index];
+        ExceptionStats *entry = &stats[record->number];
+        uint64_t delta = (index == 0) ? 0 : record->time - records[index - 1].time;
+
+        printf("%14.3f %12.3f  %-6s %-12s 0x%08X\n", ToMicroSeconds(record->time - records[0].time, clockHz),
+               ToMicroSeconds(delta, clockHz), EventName(record->type),
+               ((record->type == TRACE_EVENT_ENTER) || (record->type == TRACE_EVENT_EXIT) || (record->type == TRACE_EVENT_FAULT)) ?
+               ExceptionName(record->number, name, sizeof(name)) : "-", (unsigned)record->arg);
+
+        if(record->type == TRACE_EVENT_START){
+            for(i = 0; i < TRACE_MAX_EXCEPTIONS; i++){
+                stats[i].periodValid = 0;    /* No period across a gap in the trace */
+            }
+        }
+        else if(record->type == TRACE_EVENT_ENTER){
+            if(entry->periodValid){
+                uint64_t period = record->time - entry->lastEnter;
+                if((entry->periodCount == 0) || (period < entry->periodMin)) entry->periodMin = period;
+                if(period > entry->periodMax) entry->periodMax = period;
+                entry->periodCount++;
+            }
+            if(record->number == TRACE_SYSTICK_EXCEPTION_NUM){
+                uint64_t latency = record->cycles;    /* Cycles since the reload that pended the SysTick interrupt */
+                if((entry->latencyCount == 0) || (latency < entry->latencyMin)) entry->latencyMin = latency;
+                if(latency > entry->latencyMax) entry->latencyMax = latency;
+                entry->latencySum += latency;
+                entry->latencyCount++;
+            }
+            entry->count++;
+            entry->lastEnter = record->time;
+            entry->periodValid = 1;
+            entry->inside = 1;
+        }
+        else if((record->type == TRACE_EVENT_EXIT) && entry->inside){
+            uint64_t duration = record->time - entry->lastEnter;
+            if((entry->durationCount == 0) || (duration < entry->durationMin)) entry->durationMin = duration;
+            if(duration > entry->durationMax) entry->durationMax = duration;
+            entry->durationSum += duration;
+            entry->durationCount++;
+            entry->inside = 0;
+        }
+    }
+
+    printf("\n%-12s %8s %12s %12s %12s %12s %12s %12s %12s %12s\n", "source", "count", "dur min(us)", "dur avg(us)",
+           "dur max(us)", "per min(us)", "per max(us)", "lat min(us)", "lat avg(us)", "lat max(us)");
+    for(i = 0; i < TRACE_MAX_EXCEPTIONS; i++){
+        ExceptionStats *entry = &stats[i];
+
+        if(entry->count == 0){
+            continue;
+        }
+        printf("%-12s %8u", ExceptionName((uint8_t)i, name, sizeof(name)), (unsigned)entry->count);
+        if(entry->durationCount != 0){
+            printf(" %12.3f %12.3f %12.3f", ToMicroSeconds(entry->durationMin, clockHz),
+                   ToMicroSeconds(entry->durationSum, clockHz) / entry->durationCount,
+                   ToMicroSeconds(entry->durationMax, clockHz));
+        }
+        else{
+            printf(" %12s %12s %12s", "-", "-", "-");    /* No completed ENTER/EXIT pair */
+        }
+        if(entry->periodCount != 0){
+            printf(" %12.3f %12.3f", ToMicroSeconds(entry->periodMin, clockHz), ToMicroSeconds(entry->periodMax, clockHz));
+        }
+        else{
+            printf(" %12s %12s", "-", "-");                /* Less than two entries */
+        }
+        if(entry->latencyCount != 0){
+            printf(" %12.3f %12.3f %12.3f\n", ToMicroSeconds(entry->latencyMin, clockHz),
+                   ToMicroSeconds(entry->latencySum, clockHz) / entry->latencyCount,
+                   ToMicroSeconds(entry->latencyMax, clockHz));
+        }
+        else{
+            printf(" %12s %12s %12s\n", "-", "-", "-");    /* Only known for SysTick */
+        }
+    }
+
+    free(records);
+    free(stats);
+    return 0;
+}